@@ -1,7 +1,11 @@
 #include <pebble.h>
 #include "barcode_window.h"
+#include "launch_benchmark.h"
 
 int main(void) {
+#if BENCHMARK_LAUNCH
+  launch_benchmark_start();
+#endif
   barcode_window_push(true);
   app_event_loop();
 }
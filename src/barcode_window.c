@@ -1,6 +1,8 @@
 #include <pebble.h>
 #include "card_window.h"
 #include "defines.h"
+#include "idle_scheduler.h"
+#include "launch_benchmark.h"
 #include "pdf417.h"
 #include "settings_window.h"
 
@@ -13,6 +15,8 @@ static BitmapLayer *s_bitmaplayer_barcode;
 static char s_text_card_number[20] = ZEROS " " ZEROS " " ZEROS " " ZEROS;
 static TextLayer *s_textlayer_card_number;
 static bool s_has_appeared = false;
+static Layer *s_layer_frame;
+static bool s_has_drawn = false;
 
 static void handle_window_appear(Window *window);
 static void handle_window_unload(Window *window);
@@ -23,6 +27,7 @@ static void handle_single_click(ClickRecognizerRef recognizer, void *context);
 void barcode_window_push(bool animated) {
   initialize_ui();
   s_has_appeared = false;
+  s_has_drawn = false;
 
   window_set_click_config_provider(s_window, click_config_provider);
   window_set_window_handlers(s_window, (WindowHandlers){
@@ -36,6 +41,22 @@ void barcode_window_pop(bool animated) {
   window_stack_remove(s_window, animated);
 }
 
+// added after every other layer, so it draws last in each frame
+static void layer_frame_update_proc(Layer *layer, GContext *ctx) {
+#if BENCHMARK_LAUNCH
+  // the first call with a barcode set comes in the frame that first shows it
+  if (s_bitmap_barcode != NULL) {
+    launch_benchmark_barcode_drawn();
+  }
+#endif
+
+  // deferred work waits until the first frame is out, so it never delays it
+  if (!s_has_drawn) {
+    s_has_drawn = true;
+    idle_scheduler_start();
+  }
+}
+
 static void initialize_ui(void) {
   s_window = window_create();
   window_set_background_color(s_window, PBL_IF_COLOR_ELSE(GColorWindsorTan, GColorBlack));
@@ -65,6 +86,10 @@ static void initialize_ui(void) {
   layer_add_child(root_layer, (Layer *)s_bitmaplayer_barcode);
   layer_add_child(root_layer, (Layer *)s_bitmaplayer_app_icon);
   layer_add_child(root_layer, (Layer *)s_textlayer_card_number);
+
+  s_layer_frame = layer_create(barcode_frame);
+  layer_set_update_proc(s_layer_frame, layer_frame_update_proc);
+  layer_add_child(root_layer, s_layer_frame);
 }
 
 static void persist_read_barcode(void) {
@@ -85,6 +110,16 @@ static void app_timer_callback(void *data) {
   card_window_push(true);
 }
 
+static bool idle_job_prewarm_settings(void *context) {
+  settings_window_prewarm(layer_get_bounds(window_get_root_layer(s_window)));
+  return true;
+}
+
+static bool idle_job_preload_card(void *context) {
+  card_window_preload();
+  return true;
+}
+
 static void handle_window_appear(Window *window) {
   if (!persist_exists(STORAGE_CARD_NUMBER)) {
     if (s_has_appeared) {
@@ -99,15 +134,23 @@ static void handle_window_appear(Window *window) {
   }
 
   persist_read_barcode();
+
+  if (!s_has_appeared) {
+    idle_scheduler_add(idle_job_prewarm_settings, NULL, 1);
+    idle_scheduler_add(idle_job_preload_card, NULL, 0);
+  }
   s_has_appeared = true;
 }
 
 static void handle_window_unload(Window *window) {
+  idle_scheduler_stop();
+  card_window_release();
   window_destroy(window);
   gbitmap_destroy(s_bitmap_app_icon);
   bitmap_layer_destroy(s_bitmaplayer_app_icon);
   bitmap_layer_destroy(s_bitmaplayer_barcode);
   text_layer_destroy(s_textlayer_card_number);
+  layer_destroy(s_layer_frame);
 
   if (s_bitmap_barcode != NULL) {
     gbitmap_destroy(s_bitmap_barcode), s_bitmap_barcode = NULL;
@@ -48,6 +48,25 @@ void card_window_pop(bool animated) {
   window_stack_remove(s_window, animated);
 }
 
+// loads the arrow bitmaps ahead of the first push; they stay loaded until card_window_release
+void card_window_preload(void) {
+  if (s_bitmap_down_arrow == NULL) {
+    s_bitmap_down_arrow = gbitmap_create_with_resource(RESOURCE_ID_IMAGE_DOWN_ARROW);
+  }
+  if (s_bitmap_up_arrow == NULL) {
+    s_bitmap_up_arrow = gbitmap_create_with_resource(RESOURCE_ID_IMAGE_UP_ARROW);
+  }
+}
+
+void card_window_release(void) {
+  if (s_bitmap_down_arrow != NULL) {
+    gbitmap_destroy(s_bitmap_down_arrow), s_bitmap_down_arrow = NULL;
+  }
+  if (s_bitmap_up_arrow != NULL) {
+    gbitmap_destroy(s_bitmap_up_arrow), s_bitmap_up_arrow = NULL;
+  }
+}
+
 char *card_window_get_value(void) {
   return s_value;
 }
@@ -113,8 +132,9 @@ static void initialize_ui(void) {
   layer_add_child(s_layer_selection, (Layer *)s_textlayer_selection_value);
 #endif
 
+  card_window_preload();
+
   const GRect down_arrow_frame = PBL_IF_ROUND_ELSE((GRect(42, 110, 5, 3)), (GRect(24, 81, 5, 3)));
-  s_bitmap_down_arrow = gbitmap_create_with_resource(RESOURCE_ID_IMAGE_DOWN_ARROW);
   s_bitmaplayer_down_arrow = bitmap_layer_create(down_arrow_frame);
   bitmap_layer_set_bitmap(s_bitmaplayer_down_arrow, s_bitmap_down_arrow);
 #if PBL_COLOR
@@ -123,7 +143,6 @@ static void initialize_ui(void) {
   layer_add_child(root_layer, (Layer *)s_bitmaplayer_down_arrow);
 
   const GRect up_arrow_frame = PBL_IF_ROUND_ELSE((GRect(42, 83, 5, 3)), (GRect(24, 54, 5, 3)));
-  s_bitmap_up_arrow = gbitmap_create_with_resource(RESOURCE_ID_IMAGE_UP_ARROW);
   s_bitmaplayer_up_arrow = bitmap_layer_create(up_arrow_frame);
   bitmap_layer_set_bitmap(s_bitmaplayer_up_arrow, s_bitmap_up_arrow);
 #if PBL_COLOR
@@ -144,8 +163,9 @@ static void handle_window_unload(Window *window) {
   text_layer_destroy(s_textlayer_selection_value);
   layer_destroy(s_layer_selection);
 #endif
-  gbitmap_destroy(s_bitmap_down_arrow);
-  gbitmap_destroy(s_bitmap_up_arrow);
+  bitmap_layer_destroy(s_bitmaplayer_down_arrow);
+  bitmap_layer_destroy(s_bitmaplayer_up_arrow);
+  card_window_release();
 }
 
 static void click_config_provider(void *context) {
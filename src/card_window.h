@@ -2,5 +2,7 @@
 
 extern void card_window_push(bool animated);
 extern void card_window_pop(bool animated);
+extern void card_window_preload(void);
+extern void card_window_release(void);
 extern char *card_window_get_value(void);
 extern void card_window_set_value(char *value);
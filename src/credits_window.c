@@ -1,5 +1,6 @@
 #include <pebble.h>
 #include "credits_window.h"
+#include "text_cache.h"
 
 static Window *s_window;
 static MenuLayer *s_menulayer_credits;
@@ -34,6 +35,7 @@ static SimpleMenuSection s_simplemenusection_sections[] = {
 
 static void initialize_ui(void);
 static void handle_window_unload(Window *window);
+static GRect header_get_draw_rect(GRect bounds, uint16_t section_index);
 static void menu_layer_draw_header_callback(GContext *ctx, const Layer *cell_layer, uint16_t section_index, void *callback_context);
 static void menu_layer_draw_row_callback(GContext *ctx, const Layer *cell_layer, MenuIndex *cell_index, void *callback_context);
 static int16_t menu_layer_get_cell_height_callback(struct MenuLayer *menu_layer, MenuIndex *cell_index, void *callback_context);
@@ -73,6 +75,26 @@ static void initialize_ui(void) {
 #endif
   menu_layer_set_click_config_onto_window(s_menulayer_credits, s_window);
   layer_add_child(root_layer, menu_layer_get_layer(s_menulayer_credits));
+
+  text_cache_get_font(FONT_KEY_GOTHIC_14_BOLD);
+#if PBL_ROUND
+  for (uint16_t i = 0; i < ARRAY_LENGTH(s_simplemenusection_sections); i++) {
+    GRect bounds = layer_get_bounds(root_layer);
+    bounds.size.h = menu_layer_get_header_height_callback(s_menulayer_credits, i, NULL);
+    text_cache_get_size(s_simplemenusection_sections[i].title, FONT_KEY_GOTHIC_14_BOLD, header_get_draw_rect(bounds, i),
+      GTextOverflowModeTrailingEllipsis, GTextAlignmentCenter);
+  }
+#endif
+}
+
+static GRect header_get_draw_rect(GRect bounds, uint16_t section_index) {
+  bounds.origin.x += 2;
+  bounds.size.w -= 4;
+  if (section_index == 1) {
+    bounds.origin.y += MENU_CELL_BASIC_HEADER_HEIGHT;
+    bounds.size.h -= MENU_CELL_BASIC_HEADER_HEIGHT;
+  }
+  return bounds;
 }
 
 static void handle_window_unload(Window *window) {
@@ -92,19 +114,13 @@ static int16_t menu_layer_get_cell_height_callback(MenuLayer *menu_layer, MenuIn
 
 static void menu_layer_draw_header_callback(GContext *ctx, const Layer *cell_layer, uint16_t section_index, void *callback_context) {
   const char *title = s_simplemenusection_sections[section_index].title;
-  GFont font = fonts_get_system_font(FONT_KEY_GOTHIC_14_BOLD);
+  GFont font = text_cache_get_font(FONT_KEY_GOTHIC_14_BOLD);
   GTextOverflowMode overflow = GTextOverflowModeTrailingEllipsis;
   GTextAlignment align = PBL_IF_ROUND_ELSE(GTextAlignmentCenter, GTextAlignmentLeft);
-  GRect draw_rect = layer_get_bounds(cell_layer);
-  draw_rect.origin.x += 2;
-  draw_rect.size.w -= 4;
-  if (section_index == 1) {
-    draw_rect.origin.y += MENU_CELL_BASIC_HEADER_HEIGHT;
-    draw_rect.size.h -= MENU_CELL_BASIC_HEADER_HEIGHT;
-  }
+  GRect draw_rect = header_get_draw_rect(layer_get_bounds(cell_layer), section_index);
 
 #if PBL_ROUND
-  const GSize size = graphics_text_layout_get_content_size(title, font, draw_rect, overflow, align);
+  const GSize size = text_cache_get_size(title, FONT_KEY_GOTHIC_14_BOLD, draw_rect, overflow, align);
   GPoint p0 = GPoint((draw_rect.size.w - size.w) / 2 + 1, draw_rect.origin.y + draw_rect.size.h - 2);
   GPoint p1 = GPoint(p0.x + size.w, p0.y);
   graphics_context_set_stroke_color(ctx, GColorChromeYellow);
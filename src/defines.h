@@ -4,3 +4,6 @@
 // strings
 #define DOT "\u2022"
 #define ZEROS "0000"
+
+// card number seeded by the launch benchmark build
+#define BENCHMARK_CARD_NUMBER "1234567890123456"
@@ -0,0 +1,78 @@
+#include <pebble.h>
+#include "idle_scheduler.h"
+
+// delay before each slice, so button presses queued meanwhile are handled first
+#define YIELD_DELAY_MS 50
+// a slice stops running steps once it has used this much time
+#define SLICE_MS 5
+
+typedef struct {
+  IdleJobCallback callback;
+  void *context;
+  uint8_t priority;
+} IdleJob;
+
+static IdleJob s_jobs[4];
+static size_t s_jobs_count = 0;
+static AppTimer *s_timer;
+
+static void app_timer_callback(void *data);
+
+bool idle_scheduler_add(IdleJobCallback callback, void *context, uint8_t priority) {
+  if (s_jobs_count >= ARRAY_LENGTH(s_jobs)) {
+    return false;
+  }
+
+  s_jobs[s_jobs_count++] = (IdleJob){ .callback = callback, .context = context, .priority = priority };
+  return true;
+}
+
+void idle_scheduler_start(void) {
+  if (s_timer == NULL && s_jobs_count > 0) {
+    s_timer = app_timer_register(YIELD_DELAY_MS, app_timer_callback, NULL);
+  }
+}
+
+void idle_scheduler_stop(void) {
+  if (s_timer != NULL) {
+    app_timer_cancel(s_timer), s_timer = NULL;
+  }
+  s_jobs_count = 0;
+}
+
+static size_t next_job_index(void) {
+  size_t index = 0;
+  for (size_t i = 1; i < s_jobs_count; i++) {
+    if (s_jobs[i].priority > s_jobs[index].priority) {
+      index = i;
+    }
+  }
+  return index;
+}
+
+static void app_timer_callback(void *data) {
+  s_timer = NULL;
+
+  time_t start_seconds;
+  uint16_t start_milliseconds;
+  time_ms(&start_seconds, &start_milliseconds);
+
+  while (s_jobs_count > 0) {
+    const size_t index = next_job_index();
+    if (s_jobs[index].callback(s_jobs[index].context)) {
+      s_jobs_count--;
+      memmove(&s_jobs[index], &s_jobs[index + 1], (s_jobs_count - index) * sizeof(IdleJob));
+    }
+
+    time_t seconds;
+    uint16_t milliseconds;
+    time_ms(&seconds, &milliseconds);
+    if ((int)(seconds - start_seconds) * 1000 + milliseconds - start_milliseconds >= SLICE_MS) {
+      break;
+    }
+  }
+
+  if (s_jobs_count > 0) {
+    s_timer = app_timer_register(YIELD_DELAY_MS, app_timer_callback, NULL);
+  }
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <pebble.h>
+
+// does one short step of work and returns true once the job is finished
+typedef bool (*IdleJobCallback)(void *context);
+
+// returns false if the job queue is full; higher priorities run first
+extern bool idle_scheduler_add(IdleJobCallback callback, void *context, uint8_t priority);
+// runs queued jobs in short slices on app_timer, leaving the event loop free between them;
+// call once the first frame has been drawn
+extern void idle_scheduler_start(void);
+extern void idle_scheduler_stop(void);
@@ -0,0 +1,31 @@
+#include <pebble.h>
+#include "defines.h"
+#include "launch_benchmark.h"
+
+#if BENCHMARK_LAUNCH
+static time_t s_seconds;
+static uint16_t s_milliseconds;
+static bool s_has_logged = false;
+
+void launch_benchmark_start(void) {
+  time_ms(&s_seconds, &s_milliseconds);
+
+  if (!persist_exists(STORAGE_CARD_NUMBER)) {
+    persist_write_string(STORAGE_CARD_NUMBER, BENCHMARK_CARD_NUMBER);
+  }
+}
+
+void launch_benchmark_barcode_drawn(void) {
+  if (s_has_logged) {
+    return;
+  }
+
+  time_t seconds;
+  uint16_t milliseconds;
+  time_ms(&seconds, &milliseconds);
+
+  const int elapsed = (int)(seconds - s_seconds) * 1000 + milliseconds - s_milliseconds;
+  APP_LOG(APP_LOG_LEVEL_INFO, "launch_to_barcode_ms=%d", elapsed);
+  s_has_logged = true;
+}
+#endif
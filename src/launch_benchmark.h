@@ -0,0 +1,6 @@
+#pragma once
+#include <pebble.h>
+
+// only built into the app when BENCHMARK_LAUNCH is defined (see tools/launch_benchmark.py)
+extern void launch_benchmark_start(void);
+extern void launch_benchmark_barcode_drawn(void);
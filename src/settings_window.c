@@ -3,6 +3,7 @@
 #include "credits_window.h"
 #include "defines.h"
 #include "settings_window.h"
+#include "text_cache.h"
 
 static Window *s_window;
 static MenuLayer *s_menulayer;
@@ -10,6 +11,7 @@ static const char *const message = "JavaPay is free. Heart it on the Pebble App
 
 static void handle_window_unload(Window *window);
 static void initialize_ui(void);
+static GSize message_get_size(GRect bounds);
 static void menu_layer_draw_header_callback(GContext *ctx, const Layer *cell_layer, uint16_t section_index, void *callback_context);
 static void menu_layer_draw_row_callback(GContext *ctx, const Layer *cell_layer, MenuIndex *cell_index, void *callback_context);
 static int16_t menu_layer_get_cell_height_callback(struct MenuLayer *menu_layer, MenuIndex *cell_index, void *callback_context);
@@ -31,6 +33,12 @@ void settings_window_pop(bool animated) {
   window_stack_remove(s_window, animated);
 }
 
+void settings_window_prewarm(GRect bounds) {
+  message_get_size(bounds);
+  text_cache_get_font(FONT_KEY_GOTHIC_14);
+  text_cache_get_font(FONT_KEY_GOTHIC_28);
+}
+
 static void initialize_ui(void) {
   s_window = window_create();
 
@@ -52,6 +60,14 @@ static void initialize_ui(void) {
 #endif
   menu_layer_set_click_config_onto_window(s_menulayer, s_window);
   layer_add_child(root_layer, menu_layer_get_layer(s_menulayer));
+
+  settings_window_prewarm(layer_get_bounds(menu_layer_get_layer(s_menulayer)));
+}
+
+static GSize message_get_size(GRect bounds) {
+  bounds.origin.x += 4;
+  bounds.size.w -= 8;
+  return text_cache_get_size(message, FONT_KEY_GOTHIC_18, bounds, GTextOverflowModeWordWrap, GTextAlignmentLeft);
 }
 
 static void handle_window_unload(Window *window) {
@@ -61,17 +77,8 @@ static void handle_window_unload(Window *window) {
 
 static int16_t menu_layer_get_cell_height_callback(MenuLayer *menu_layer, MenuIndex *cell_index, void *callback_context) {
   switch (cell_index->section) {
-    case 0: {
-      static int16_t h = -1;
-      if (h < 0) {
-        GRect draw_rect = layer_get_bounds(menu_layer_get_layer(menu_layer));
-        draw_rect.origin.x += 4;
-        draw_rect.size.w -= 8;
-        GSize size = graphics_text_layout_get_content_size(message, fonts_get_system_font(FONT_KEY_GOTHIC_18), draw_rect, GTextOverflowModeWordWrap, GTextAlignmentLeft);
-        h = size.h + 8;
-      }
-      return h;
-    }
+    case 0:
+      return message_get_size(layer_get_bounds(menu_layer_get_layer(menu_layer))).h + 8;
     case 1:
       return 32;
     default:
@@ -99,7 +106,7 @@ static void menu_layer_draw_header_callback(GContext *ctx, const Layer *cell_lay
     graphics_context_set_text_color(ctx, GColorBlack);
 #endif
 
-    graphics_draw_text(ctx, "Version 1.3", fonts_get_system_font(FONT_KEY_GOTHIC_14), draw_rect, GTextOverflowModeTrailingEllipsis, GTextAlignmentCenter, NULL);
+    graphics_draw_text(ctx, "Version 1.3", text_cache_get_font(FONT_KEY_GOTHIC_14), draw_rect, GTextOverflowModeTrailingEllipsis, GTextAlignmentCenter, NULL);
   }
 }
 
@@ -117,7 +124,7 @@ static void menu_layer_draw_row_callback(GContext *ctx, const Layer *cell_layer,
 
   switch (cell_index->section) {
     case 0:
-      graphics_draw_text(ctx, message, fonts_get_system_font(FONT_KEY_GOTHIC_18), draw_rect, overflow, align, NULL);
+      graphics_draw_text(ctx, message, text_cache_get_font(FONT_KEY_GOTHIC_18), draw_rect, overflow, align, NULL);
       break;
 
     case 1: {
@@ -129,7 +136,7 @@ static void menu_layer_draw_row_callback(GContext *ctx, const Layer *cell_layer,
       }
 
       draw_rect.origin.y -= 3;
-      graphics_draw_text(ctx, text, fonts_get_system_font(FONT_KEY_GOTHIC_28), draw_rect, overflow, align, NULL);
+      graphics_draw_text(ctx, text, text_cache_get_font(FONT_KEY_GOTHIC_28), draw_rect, overflow, align, NULL);
       break;
     }
   }
@@ -2,3 +2,5 @@
 
 extern void settings_window_push(bool animated);
 extern void settings_window_pop(bool animated);
+// bounds are the menu's; it fills its window, so any full-screen window's root layer will do
+extern void settings_window_prewarm(GRect bounds);
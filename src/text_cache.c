@@ -0,0 +1,48 @@
+#include <pebble.h>
+#include "text_cache.h"
+
+typedef struct {
+  const char *font_key;
+  GFont font;
+} FontEntry;
+
+typedef struct {
+  const char *text;
+  const char *font_key;
+  int16_t width;
+  GSize size;
+} SizeEntry;
+
+static FontEntry s_fonts[6];
+static size_t s_fonts_count = 0;
+static SizeEntry s_sizes[8];
+static size_t s_sizes_count = 0;
+
+GFont text_cache_get_font(const char *font_key) {
+  for (size_t i = 0; i < s_fonts_count; i++) {
+    if (strcmp(s_fonts[i].font_key, font_key) == 0) {
+      return s_fonts[i].font;
+    }
+  }
+
+  GFont font = fonts_get_system_font(font_key);
+  if (s_fonts_count < ARRAY_LENGTH(s_fonts)) {
+    s_fonts[s_fonts_count++] = (FontEntry){ .font_key = font_key, .font = font };
+  }
+  return font;
+}
+
+GSize text_cache_get_size(const char *text, const char *font_key, GRect box, GTextOverflowMode overflow, GTextAlignment alignment) {
+  for (size_t i = 0; i < s_sizes_count; i++) {
+    SizeEntry *entry = &s_sizes[i];
+    if (entry->text == text && entry->width == box.size.w && strcmp(entry->font_key, font_key) == 0) {
+      return entry->size;
+    }
+  }
+
+  GSize size = graphics_text_layout_get_content_size(text, text_cache_get_font(font_key), box, overflow, alignment);
+  if (s_sizes_count < ARRAY_LENGTH(s_sizes)) {
+    s_sizes[s_sizes_count++] = (SizeEntry){ .text = text, .font_key = font_key, .width = box.size.w, .size = size };
+  }
+  return size;
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <pebble.h>
+
+// Windows fill the cache when they load, so menu callbacks never measure text while scrolling.
+
+// font_key must be one of the FONT_KEY_* constants
+extern GFont text_cache_get_font(const char *font_key);
+// text must outlive the cache; entries are keyed by text pointer, font and width
+extern GSize text_cache_get_size(const char *text, const char *font_key, GRect box, GTextOverflowMode overflow, GTextAlignment alignment);
@@ -0,0 +1,129 @@
+// Drives the app with button presses the way a user would, checks what ends up
+// on screen, and reports what every handler cost. Fails if entering digits
+// allocates, if menus measure text while scrolling, or if a handler blows
+// through CPU_BUDGET_US.
+
+#include <pebble.h>
+#include <stdio.h>
+#include "../src/barcode_window.h"
+#include "../src/defines.h"
+#include "sim.h"
+
+#define CARD_NUMBER "1234567890123456"
+#define CARD_NUMBER_TEXT "1234 5678 9012 3456"
+// host CPU per call; the watch is far slower, so this only catches gross regressions
+#define CPU_BUDGET_US 20000
+
+static void press(ButtonId button) {
+  sim_press(button);
+  sim_render();
+}
+
+static void check_profiles(const char *flow) {
+  sim_profile_report(flow);
+  for (size_t i = 0; i < sim_profile_count(); i++) {
+    const SimProfile *profile = sim_profile_at(i);
+    SIM_CHECK(profile->max_cpu_ns <= CPU_BUDGET_US * 1000ull, "%s: %s took %.1f us, over %d", flow, profile->label,
+      profile->max_cpu_ns / 1000.0, CPU_BUDGET_US);
+  }
+}
+
+static void check_no_allocs(const char *flow, const char *label) {
+  const SimProfile *profile = sim_profile(label);
+  SIM_CHECK(profile != NULL, "%s: %s never ran", flow, label);
+  if (profile != NULL) {
+    SIM_CHECK(profile->allocs == 0, "%s: %s made %zu allocations", flow, label, profile->allocs);
+  }
+}
+
+// no card yet: every digit is entered with up and select, and saving shows the barcode
+static void test_enter_card(void) {
+  sim_reset();
+  barcode_window_push(true);
+  sim_render();
+  sim_advance(250);
+  sim_render();
+  SIM_CHECK(sim_top_window_name() != NULL && strcmp(sim_top_window_name(), "card_window") == 0,
+    "enter_card: card window not opened");
+
+  for (const char *digit = CARD_NUMBER; *digit != '\0'; digit++) {
+    for (char value = '0'; value < *digit; value++) {
+      press(BUTTON_ID_UP);
+    }
+    press(BUTTON_ID_SELECT);
+  }
+  SIM_CHECK(sim_window_count() == 1, "enter_card: card window still open");
+
+  char saved[sizeof(CARD_NUMBER)] = "";
+  persist_read_string(STORAGE_CARD_NUMBER, saved, sizeof(saved));
+  SIM_CHECK(strcmp(saved, CARD_NUMBER) == 0, "enter_card: saved \"%s\"", saved);
+  SIM_CHECK(sim_frame_has_text(CARD_NUMBER_TEXT), "enter_card: card number not drawn");
+  SIM_CHECK(sim_frame_bitmap_count() == 2, "enter_card: drew %zu bitmaps, not the logo and barcode", sim_frame_bitmap_count());
+
+  check_no_allocs("enter_card", "card_window.click(UP)");
+  check_no_allocs("enter_card", "card_window.click(SELECT)");
+
+  press(BUTTON_ID_BACK);
+  SIM_CHECK(!sim_is_running(), "enter_card: app still running");
+  check_profiles("enter_card");
+}
+
+// a saved card: settings and credits are opened and scrolled, then closed with back
+static void test_browse_menus(void) {
+  sim_reset();
+  persist_write_string(STORAGE_CARD_NUMBER, CARD_NUMBER);
+  barcode_window_push(true);
+  sim_advance(1000);
+  SIM_CHECK(sim_profile("barcode_window.timer") == NULL, "browse_menus: idle work ran before the first frame");
+  sim_render();
+  SIM_CHECK(sim_frame_has_text(CARD_NUMBER_TEXT), "browse_menus: card number not drawn");
+  SIM_CHECK(sim_frame_bitmap_count() == 2, "browse_menus: drew %zu bitmaps, not the logo and barcode", sim_frame_bitmap_count());
+  sim_advance(1000);
+  SIM_CHECK(sim_profile("barcode_window.timer") != NULL, "browse_menus: idle work never ran");
+
+  press(BUTTON_ID_SELECT);
+  SIM_CHECK(sim_top_window_name() != NULL && strcmp(sim_top_window_name(), "settings_window") == 0,
+    "browse_menus: settings not opened");
+
+  size_t measures = sim_text_measure_count();
+  size_t font_loads = sim_font_load_count();
+  press(BUTTON_ID_DOWN);
+  press(BUTTON_ID_DOWN);
+  SIM_CHECK(sim_frame_has_text("Credits"), "browse_menus: settings rows not drawn");
+  press(BUTTON_ID_UP);
+  press(BUTTON_ID_DOWN);
+  SIM_CHECK(sim_text_measure_count() == measures, "browse_menus: settings measured text %zu times while scrolling",
+    sim_text_measure_count() - measures);
+  SIM_CHECK(sim_font_load_count() == font_loads, "browse_menus: settings loaded fonts %zu times while scrolling",
+    sim_font_load_count() - font_loads);
+
+  press(BUTTON_ID_SELECT);
+  SIM_CHECK(sim_top_window_name() != NULL && strcmp(sim_top_window_name(), "credits_window") == 0,
+    "browse_menus: credits not opened");
+
+  measures = sim_text_measure_count();
+  font_loads = sim_font_load_count();
+  for (int i = 0; i < 8; i++) {
+    press(BUTTON_ID_DOWN);
+  }
+  SIM_CHECK(sim_frame_has_text("Zach Waldowski"), "browse_menus: last credit not drawn");
+  SIM_CHECK(sim_text_measure_count() == measures, "browse_menus: credits measured text %zu times while scrolling",
+    sim_text_measure_count() - measures);
+  SIM_CHECK(sim_font_load_count() == font_loads, "browse_menus: credits loaded fonts %zu times while scrolling",
+    sim_font_load_count() - font_loads);
+
+  press(BUTTON_ID_BACK);
+  press(BUTTON_ID_BACK);
+  SIM_CHECK(sim_top_window_name() != NULL && strcmp(sim_top_window_name(), "barcode_window") == 0,
+    "browse_menus: not back at the barcode");
+  press(BUTTON_ID_BACK);
+  SIM_CHECK(!sim_is_running(), "browse_menus: app still running");
+  check_profiles("browse_menus");
+}
+
+int main(void) {
+  test_enter_card();
+  test_browse_menus();
+  sim_reset();
+  return sim_failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,83 @@
+// Renders barcodes in the format this platform encodes them in and checks them
+// pixel by pixel against the 1-bit encoder, which is the same pdf417.c built
+// for aplite and linked in as pdf417_create_bitmap_1bit. The 1-bit output itself
+// is pinned by a checksum, so a change to the shared encoding fails too.
+
+#include <pebble.h>
+#include <stdio.h>
+#include "../src/pdf417.h"
+#include "sim.h"
+
+GBitmap *pdf417_create_bitmap_1bit(const char *input);
+
+static const struct {
+  const char *input;
+  uint32_t checksum;
+} s_cases[] = {
+  { "0000000000000000", 0xdf678919 },
+  { "1234567890123456", 0x32c71495 },
+  { "5555444433332222", 0xf20c8c3d },
+  { "9999999999999999", 0xddb9a995 },
+};
+
+static bool pixel_is_white(const GBitmap *bitmap, int x, int y) {
+  const uint8_t *row = gbitmap_get_data(bitmap) + gbitmap_get_bytes_per_row(bitmap) * y;
+  switch (gbitmap_get_format(bitmap)) {
+    case GBitmapFormat1Bit:
+      return row[x / 8] & (1 << (x % 8));
+    case GBitmapFormat2BitPalette:
+      return gbitmap_get_palette(bitmap)[(row[x / 4] >> (2 * (3 - x % 4))) & 3].argb == GColorWhiteARGB8;
+    case GBitmapFormat8Bit:
+      return row[x] == GColorWhiteARGB8;
+    default:
+      SIM_CHECK(false, "unexpected bitmap format %d", gbitmap_get_format(bitmap));
+      return false;
+  }
+}
+
+// FNV-1a over the white pixels, row by row
+static uint32_t bitmap_checksum(const GBitmap *bitmap) {
+  const GRect bounds = gbitmap_get_bounds(bitmap);
+  uint32_t hash = 2166136261u;
+  for (int y = 0; y < bounds.size.h; y++) {
+    for (int x = 0; x < bounds.size.w; x++) {
+      hash = (hash ^ pixel_is_white(bitmap, x, y)) * 16777619u;
+    }
+  }
+  return hash;
+}
+
+static void test_matches_1bit(const char *input, uint32_t checksum) {
+  GBitmap *reference = pdf417_create_bitmap_1bit(input);
+  GBitmap *bitmap = pdf417_create_bitmap(input);
+
+  const uint32_t reference_checksum = bitmap_checksum(reference);
+  SIM_CHECK(reference_checksum == checksum, "%s: 1-bit checksum 0x%08x, expected 0x%08x", input, reference_checksum, checksum);
+
+  const GRect bounds = gbitmap_get_bounds(reference);
+  const GRect other_bounds = gbitmap_get_bounds(bitmap);
+  SIM_CHECK(bounds.size.w == other_bounds.size.w && bounds.size.h == other_bounds.size.h, "%s: %dx%d, expected %dx%d",
+    input, other_bounds.size.w, other_bounds.size.h, bounds.size.w, bounds.size.h);
+
+  int mismatches = 0;
+  for (int y = 0; y < bounds.size.h && y < other_bounds.size.h; y++) {
+    for (int x = 0; x < bounds.size.w && x < other_bounds.size.w; x++) {
+      if (pixel_is_white(bitmap, x, y) != pixel_is_white(reference, x, y) && mismatches++ == 0) {
+        SIM_CHECK(false, "%s: first mismatch at (%d, %d)", input, x, y);
+      }
+    }
+  }
+  SIM_CHECK(mismatches == 0, "%s: %d pixels differ from the 1-bit encoder", input, mismatches);
+  printf("[pdf417] %s %s: format %d, %d pixels differ\n", SIM_PLATFORM, input, gbitmap_get_format(bitmap), mismatches);
+
+  gbitmap_destroy(bitmap);
+  gbitmap_destroy(reference);
+}
+
+int main(void) {
+  for (size_t i = 0; i < ARRAY_LENGTH(s_cases); i++) {
+    test_matches_1bit(s_cases[i].input, s_cases[i].checksum);
+  }
+  SIM_CHECK(sim_heap_current() == 0, "%zu bytes leaked", sim_heap_current());
+  return sim_failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,1235 @@
+// Fake Pebble runtime for host tests: a window stack with click handling, layers
+// that draw through their update procs and record what they drew, app timers on
+// a virtual clock, in-memory persist, a counting heap that charges every
+// allocation to the window whose code made it, and per-handler CPU profiles.
+//
+// Heap numbers are what the watch would use: firmware objects are charged their
+// size on the watch, not the size of this file's stand-ins, every block pays the
+// allocator's header and rounding, and bitmap buffers match byte for byte.
+
+#define SIM_RUNTIME
+#include <pebble.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include "sim.h"
+
+#define SCREEN_WIDTH PBL_IF_ROUND_ELSE(180, 144)
+#define SCREEN_HEIGHT PBL_IF_ROUND_ELSE(180, 168)
+
+// heap
+
+// the app heap's per-block header and allocation granularity
+#define WATCH_BLOCK_HEADER 8
+#define WATCH_BLOCK_ALIGN 4
+
+// sizes of the firmware's objects, from the 3.x firmware's structs on its 32-bit ARM
+// build; aplite, basalt and chalk all run that firmware, so they share one table
+static const struct {
+  size_t window;
+  size_t layer;
+  size_t text_layer;
+  size_t bitmap_layer;
+  size_t menu_layer;
+  size_t gbitmap;
+} s_watch_sizes = {
+  .window = 88,
+  .layer = 44,
+  .text_layer = 60,
+  .bitmap_layer = 52,
+  .menu_layer = 320,
+  .gbitmap = 24,
+};
+
+typedef struct HeapOwner {
+  char name[32];
+  size_t current;
+  size_t peak;
+  struct HeapOwner *next;
+} HeapOwner;
+
+typedef union {
+  struct {
+    size_t size;
+    HeapOwner *owner;
+  } info;
+  max_align_t align;
+} BlockHeader;
+
+static HeapOwner s_app_owner = { .name = "app" };
+static HeapOwner *s_owners;
+static HeapOwner *s_owner = &s_app_owner;
+static size_t s_heap_current;
+static size_t s_heap_peak;
+static size_t s_alloc_count;
+static size_t s_alloc_bytes;
+
+static HeapOwner *heap_owner_create(const char *file) {
+  HeapOwner *owner = calloc(1, sizeof(HeapOwner));
+  const char *name = strrchr(file, '/');
+  name = name != NULL ? name + 1 : file;
+  snprintf(owner->name, sizeof(owner->name), "%.*s", (int)strcspn(name, "."), name);
+  owner->next = s_owners;
+  s_owners = owner;
+  return owner;
+}
+
+// allocates size bytes on the host and charges the owner for a watch_size block on the watch
+static void *heap_alloc(size_t size, size_t watch_size) {
+  const size_t charged = WATCH_BLOCK_HEADER + (watch_size + WATCH_BLOCK_ALIGN - 1) / WATCH_BLOCK_ALIGN * WATCH_BLOCK_ALIGN;
+  BlockHeader *header = malloc(sizeof(BlockHeader) + size);
+  header->info.size = charged;
+  header->info.owner = s_owner;
+
+  s_owner->current += charged;
+  if (s_owner->current > s_owner->peak) {
+    s_owner->peak = s_owner->current;
+  }
+  s_heap_current += charged;
+  if (s_heap_current > s_heap_peak) {
+    s_heap_peak = s_heap_current;
+  }
+  s_alloc_count++;
+  s_alloc_bytes += charged;
+  return header + 1;
+}
+
+// a zeroed firmware object, charged at its size on the watch
+static void *heap_alloc_object(size_t size, size_t watch_size) {
+  void *ptr = heap_alloc(size, watch_size);
+  memset(ptr, 0, size);
+  return ptr;
+}
+
+void *sim_malloc(size_t size) {
+  return heap_alloc(size, size);
+}
+
+void *sim_calloc(size_t count, size_t size) {
+  void *ptr = sim_malloc(count * size);
+  memset(ptr, 0, count * size);
+  return ptr;
+}
+
+void sim_free(void *ptr) {
+  if (ptr == NULL) {
+    return;
+  }
+
+  BlockHeader *header = (BlockHeader *)ptr - 1;
+  header->info.owner->current -= header->info.size;
+  s_heap_current -= header->info.size;
+  free(header);
+}
+
+size_t sim_heap_current(void) {
+  return s_heap_current;
+}
+
+size_t sim_heap_peak(void) {
+  return s_heap_peak;
+}
+
+// handler profiles
+
+typedef struct {
+  SimProfile *profile;
+  HeapOwner *saved_owner;
+  uint64_t start_ns;
+  size_t start_allocs;
+  size_t start_bytes;
+  uint64_t child_ns;
+  size_t child_allocs;
+  size_t child_bytes;
+} DispatchFrame;
+
+static SimProfile s_profiles[32];
+static size_t s_profiles_count;
+static DispatchFrame s_frames[8];
+static size_t s_frames_count;
+
+static uint64_t cpu_time_ns(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static SimProfile *profile_find_or_add(const char *label) {
+  for (size_t i = 0; i < s_profiles_count; i++) {
+    if (strcmp(s_profiles[i].label, label) == 0) {
+      return &s_profiles[i];
+    }
+  }
+  if (s_profiles_count == ARRAY_LENGTH(s_profiles)) {
+    return NULL;
+  }
+
+  SimProfile *profile = &s_profiles[s_profiles_count++];
+  memset(profile, 0, sizeof(SimProfile));
+  snprintf(profile->label, sizeof(profile->label), "%s", label);
+  return profile;
+}
+
+static void dispatch_begin(HeapOwner *owner, const char *event) {
+  char label[sizeof(((SimProfile *)NULL)->label)];
+  snprintf(label, sizeof(label), "%s.%s", owner->name, event);
+
+  DispatchFrame *frame = &s_frames[s_frames_count++];
+  *frame = (DispatchFrame){
+    .profile = profile_find_or_add(label),
+    .saved_owner = s_owner,
+    .start_allocs = s_alloc_count,
+    .start_bytes = s_alloc_bytes,
+  };
+  s_owner = owner;
+  frame->start_ns = cpu_time_ns();
+}
+
+// charges the handler with what it did itself; handlers it caused to run, such
+// as the appear handler of a window it pushed, get their own profiles
+static void dispatch_end(void) {
+  const uint64_t elapsed_ns = cpu_time_ns() - s_frames[s_frames_count - 1].start_ns;
+  DispatchFrame *frame = &s_frames[--s_frames_count];
+  const size_t allocs = s_alloc_count - frame->start_allocs;
+  const size_t bytes = s_alloc_bytes - frame->start_bytes;
+
+  SimProfile *profile = frame->profile;
+  if (profile != NULL) {
+    const uint64_t self_ns = elapsed_ns - frame->child_ns;
+    profile->calls++;
+    profile->cpu_ns += self_ns;
+    if (self_ns > profile->max_cpu_ns) {
+      profile->max_cpu_ns = self_ns;
+    }
+    profile->allocs += allocs - frame->child_allocs;
+    profile->alloc_bytes += bytes - frame->child_bytes;
+  }
+  if (s_frames_count > 0) {
+    DispatchFrame *parent = &s_frames[s_frames_count - 1];
+    parent->child_ns += elapsed_ns;
+    parent->child_allocs += allocs;
+    parent->child_bytes += bytes;
+  }
+  s_owner = frame->saved_owner;
+}
+
+// runs app code with its allocations charged to owner, profiled as "<owner>.<event>"
+#define DISPATCH(owner, event, call) do { \
+  dispatch_begin((owner), (event)); \
+  call; \
+  dispatch_end(); \
+} while (0)
+
+// logging
+
+void app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...) {
+  if (log_level > APP_LOG_LEVEL_WARNING && getenv("SIM_VERBOSE") == NULL) {
+    return;
+  }
+
+  const char *name = strrchr(src_filename, '/');
+  printf("[app] %s:%d ", name != NULL ? name + 1 : src_filename, src_line_number);
+  va_list args;
+  va_start(args, fmt);
+  vprintf(fmt, args);
+  va_end(args);
+  printf("\n");
+}
+
+// geometry
+
+GRect grect_crop(GRect rect, int32_t crop_size_px) {
+  return GRect(rect.origin.x + crop_size_px, rect.origin.y + crop_size_px,
+    rect.size.w - 2 * crop_size_px, rect.size.h - 2 * crop_size_px);
+}
+
+// time
+
+static uint64_t s_now_ms;
+
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms) {
+  const uint16_t ms = s_now_ms % 1000;
+  if (tloc != NULL) {
+    *tloc = (time_t)(s_now_ms / 1000);
+  }
+  if (out_ms != NULL) {
+    *out_ms = ms;
+  }
+  return ms;
+}
+
+// persist
+
+typedef struct {
+  uint32_t key;
+  char value[256];
+} PersistEntry;
+
+static PersistEntry s_persist[16];
+static size_t s_persist_count;
+
+static PersistEntry *persist_find(uint32_t key) {
+  for (size_t i = 0; i < s_persist_count; i++) {
+    if (s_persist[i].key == key) {
+      return &s_persist[i];
+    }
+  }
+  return NULL;
+}
+
+bool persist_exists(const uint32_t key) {
+  return persist_find(key) != NULL;
+}
+
+int persist_read_string(const uint32_t key, char *buffer, const size_t buffer_size) {
+  const PersistEntry *entry = persist_find(key);
+  if (entry == NULL) {
+    return E_DOES_NOT_EXIST;
+  }
+
+  snprintf(buffer, buffer_size, "%s", entry->value);
+  return (int)strlen(buffer) + 1;
+}
+
+int persist_write_string(const uint32_t key, const char *cstring) {
+  PersistEntry *entry = persist_find(key);
+  if (entry == NULL) {
+    if (s_persist_count == ARRAY_LENGTH(s_persist)) {
+      return E_ERROR;
+    }
+    entry = &s_persist[s_persist_count++];
+    entry->key = key;
+  }
+
+  snprintf(entry->value, sizeof(entry->value), "%s", cstring);
+  return (int)strlen(entry->value) + 1;
+}
+
+// app timers; these live in the kernel's heap on the watch, so they aren't counted
+
+struct AppTimer {
+  uint64_t fire_at;
+  AppTimerCallback callback;
+  void *data;
+  AppTimer *next;
+};
+
+static AppTimer *s_timers;
+
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data) {
+  AppTimer *timer = calloc(1, sizeof(AppTimer));
+  timer->fire_at = s_now_ms + timeout_ms;
+  timer->callback = callback;
+  timer->data = callback_data;
+
+  // kept sorted by fire time, so equal deadlines fire in registration order
+  AppTimer **link = &s_timers;
+  while (*link != NULL && (*link)->fire_at <= timer->fire_at) {
+    link = &(*link)->next;
+  }
+  timer->next = *link;
+  *link = timer;
+  return timer;
+}
+
+void app_timer_cancel(AppTimer *timer_handle) {
+  for (AppTimer **link = &s_timers; *link != NULL; link = &(*link)->next) {
+    if (*link == timer_handle) {
+      *link = timer_handle->next;
+      free(timer_handle);
+      return;
+    }
+  }
+}
+
+void app_event_loop(void) {
+}
+
+// bitmaps
+
+struct GBitmap {
+  GSize size;
+  GBitmapFormat format;
+  uint16_t row_size;
+  uint8_t *data;
+  GColor *palette;
+  bool free_palette;
+};
+
+static uint16_t bitmap_row_size(GBitmapFormat format, int16_t width) {
+  switch (format) {
+    case GBitmapFormat1Bit:
+      return (width + 31) / 32 * 4;
+    case GBitmapFormat8Bit:
+      return width;
+    case GBitmapFormat1BitPalette:
+      return (width + 7) / 8;
+    case GBitmapFormat2BitPalette:
+      return (width + 3) / 4;
+    case GBitmapFormat4BitPalette:
+      return (width + 1) / 2;
+  }
+  return 0;
+}
+
+GBitmap *gbitmap_create_blank(GSize size, GBitmapFormat format) {
+  GBitmap *bitmap = heap_alloc_object(sizeof(GBitmap), s_watch_sizes.gbitmap);
+  bitmap->size = size;
+  bitmap->format = format;
+  bitmap->row_size = bitmap_row_size(format, size.w);
+  bitmap->data = sim_calloc(bitmap->row_size * size.h, 1);
+  return bitmap;
+}
+
+GBitmap *gbitmap_create_blank_with_palette(GSize size, GBitmapFormat format, GColor *palette, bool free_on_destroy) {
+  GBitmap *bitmap = gbitmap_create_blank(size, format);
+  bitmap->palette = palette;
+  bitmap->free_palette = free_on_destroy;
+  return bitmap;
+}
+
+// sizes of the PNGs in resources/images; color builds keep the arrows' alpha as 8-bit
+GBitmap *gbitmap_create_with_resource(uint32_t resource_id) {
+  switch (resource_id) {
+    case RESOURCE_ID_IMAGE_UP_ARROW:
+    case RESOURCE_ID_IMAGE_DOWN_ARROW:
+      return gbitmap_create_blank(GSize(5, 3), PBL_IF_COLOR_ELSE(GBitmapFormat8Bit, GBitmapFormat1Bit));
+    case RESOURCE_ID_IMAGE_APP_ICON:
+      return gbitmap_create_blank(GSize(21, 28), PBL_IF_COLOR_ELSE(GBitmapFormat1BitPalette, GBitmapFormat1Bit));
+    case RESOURCE_ID_IMAGE_JAVAPAY:
+      return gbitmap_create_blank(GSize(119, 25), PBL_IF_COLOR_ELSE(GBitmapFormat1BitPalette, GBitmapFormat1Bit));
+  }
+  return NULL;
+}
+
+uint16_t gbitmap_get_bytes_per_row(const GBitmap *bitmap) {
+  return bitmap->row_size;
+}
+
+uint8_t *gbitmap_get_data(const GBitmap *bitmap) {
+  return bitmap->data;
+}
+
+GBitmapFormat gbitmap_get_format(const GBitmap *bitmap) {
+  return bitmap->format;
+}
+
+GColor *gbitmap_get_palette(const GBitmap *bitmap) {
+  return bitmap->palette;
+}
+
+GRect gbitmap_get_bounds(const GBitmap *bitmap) {
+  return GRect(0, 0, bitmap->size.w, bitmap->size.h);
+}
+
+void gbitmap_destroy(GBitmap *bitmap) {
+  if (bitmap == NULL) {
+    return;
+  }
+
+  if (bitmap->free_palette) {
+    sim_free(bitmap->palette);
+  }
+  sim_free(bitmap->data);
+  sim_free(bitmap);
+}
+
+// fonts and text
+
+struct FontInfo {
+  const char *key;
+  int16_t height;
+};
+
+static FontInfo s_fonts[] = {
+  { FONT_KEY_GOTHIC_14, 14 },
+  { FONT_KEY_GOTHIC_14_BOLD, 14 },
+  { FONT_KEY_GOTHIC_18, 18 },
+  { FONT_KEY_GOTHIC_18_BOLD, 18 },
+  { FONT_KEY_GOTHIC_24, 24 },
+  { FONT_KEY_GOTHIC_28, 28 },
+};
+
+static size_t s_font_load_count;
+static size_t s_text_measure_count;
+
+static GFont font_find(const char *font_key) {
+  for (size_t i = 0; i < ARRAY_LENGTH(s_fonts); i++) {
+    if (strcmp(s_fonts[i].key, font_key) == 0) {
+      return &s_fonts[i];
+    }
+  }
+  return NULL;
+}
+
+GFont fonts_get_system_font(const char *font_key) {
+  s_font_load_count++;
+  return font_find(font_key);
+}
+
+// greedy word wrap with a fixed advance of 5/12 of the font height per character
+static GSize text_layout(const char *text, GFont font, GRect box, GTextOverflowMode overflow_mode) {
+  const int advance = font->height * 5 / 12;
+  const int line_height = font->height + 4;
+  const int max_chars = box.size.w / advance > 0 ? box.size.w / advance : 1;
+
+  int lines = 0;
+  int widest = 0;
+  const char *p = text;
+  while (*p != '\0') {
+    int chars = 0;
+    int fitted = 0;
+    const char *fitted_end = p;
+    const char *q = p;
+    for (; *q != '\0' && *q != '\n'; q++) {
+      if ((*q & 0xc0) == 0x80) {
+        continue;
+      }
+      if (chars == max_chars) {
+        break;
+      }
+      chars++;
+      if (q[1] == ' ' || q[1] == '\n' || q[1] == '\0') {
+        fitted = chars;
+        fitted_end = q + 1;
+      }
+    }
+    if (*q == '\0' || *q == '\n' || fitted == 0 || overflow_mode != GTextOverflowModeWordWrap) {
+      fitted = chars;
+      fitted_end = q;
+    }
+
+    lines++;
+    if (fitted * advance > widest) {
+      widest = fitted * advance;
+    }
+    if (overflow_mode != GTextOverflowModeWordWrap || (lines + 1) * line_height > box.size.h) {
+      break;
+    }
+    p = fitted_end;
+    while (*p == ' ' || *p == '\n') {
+      p++;
+    }
+  }
+
+  return GSize(widest < box.size.w ? widest : box.size.w, lines * line_height);
+}
+
+GSize graphics_text_layout_get_content_size(const char *text, GFont const font, const GRect box, const GTextOverflowMode overflow_mode, const GTextAlignment alignment) {
+  s_text_measure_count++;
+  return text_layout(text, font, box, overflow_mode);
+}
+
+// graphics; each frame records the text and bitmaps it drew
+
+typedef struct {
+  const char *text;
+  const GBitmap *bitmap;
+} DrawRecord;
+
+static DrawRecord s_draws[64];
+static size_t s_draws_count;
+
+static void draw_record(DrawRecord record) {
+  if (s_draws_count < ARRAY_LENGTH(s_draws)) {
+    s_draws[s_draws_count++] = record;
+  }
+}
+
+struct GContext {
+  GColor stroke_color;
+  GColor fill_color;
+  GColor text_color;
+};
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color) {
+  ctx->stroke_color = color;
+}
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color) {
+  ctx->fill_color = color;
+}
+
+void graphics_context_set_text_color(GContext *ctx, GColor color) {
+  ctx->text_color = color;
+}
+
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1) {
+}
+
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask) {
+}
+
+void graphics_draw_text(GContext *ctx, const char *text, GFont const font, const GRect box, const GTextOverflowMode overflow_mode, const GTextAlignment alignment, GTextAttributes *text_attributes) {
+  text_layout(text, font, box, overflow_mode);
+  draw_record((DrawRecord){ .text = text });
+}
+
+// layers
+
+struct Layer {
+  GRect frame;
+  GRect bounds;
+  LayerUpdateProc update_proc;
+  void (*draw)(Layer *layer, GContext *ctx);
+  Layer *parent;
+  Layer *first_child;
+  Layer *next_sibling;
+};
+
+static void layer_init(Layer *layer, GRect frame) {
+  layer->frame = frame;
+  layer->bounds = GRect(0, 0, frame.size.w, frame.size.h);
+}
+
+static void layer_remove_from_parent(Layer *layer) {
+  if (layer->parent == NULL) {
+    return;
+  }
+
+  for (Layer **link = &layer->parent->first_child; *link != NULL; link = &(*link)->next_sibling) {
+    if (*link == layer) {
+      *link = layer->next_sibling;
+      break;
+    }
+  }
+  layer->parent = NULL;
+  layer->next_sibling = NULL;
+}
+
+static void layer_deinit(Layer *layer) {
+  layer_remove_from_parent(layer);
+  for (Layer *child = layer->first_child; child != NULL; child = child->next_sibling) {
+    child->parent = NULL;
+  }
+}
+
+Layer *layer_create(GRect frame) {
+  Layer *layer = heap_alloc_object(sizeof(Layer), s_watch_sizes.layer);
+  layer_init(layer, frame);
+  return layer;
+}
+
+void layer_destroy(Layer *layer) {
+  layer_deinit(layer);
+  sim_free(layer);
+}
+
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc) {
+  layer->update_proc = update_proc;
+}
+
+void layer_mark_dirty(Layer *layer) {
+}
+
+void layer_set_frame(Layer *layer, GRect frame) {
+  layer->frame = frame;
+  layer->bounds.size = frame.size;
+}
+
+GRect layer_get_frame(const Layer *layer) {
+  return layer->frame;
+}
+
+GRect layer_get_bounds(const Layer *layer) {
+  return layer->bounds;
+}
+
+void layer_add_child(Layer *parent, Layer *child) {
+  layer_remove_from_parent(child);
+  Layer **link = &parent->first_child;
+  while (*link != NULL) {
+    link = &(*link)->next_sibling;
+  }
+  *link = child;
+  child->parent = parent;
+}
+
+struct TextLayer {
+  Layer layer;
+  const char *text;
+  GFont font;
+  GColor text_color;
+  GColor background_color;
+  GTextAlignment alignment;
+  GTextOverflowMode overflow_mode;
+};
+
+static void text_layer_draw(Layer *layer, GContext *ctx) {
+  TextLayer *text_layer = (TextLayer *)layer;
+  graphics_context_set_fill_color(ctx, text_layer->background_color);
+  graphics_fill_rect(ctx, layer->bounds, 0, GCornerNone);
+  if (text_layer->text != NULL) {
+    graphics_context_set_text_color(ctx, text_layer->text_color);
+    graphics_draw_text(ctx, text_layer->text, text_layer->font, layer->bounds, text_layer->overflow_mode, text_layer->alignment, NULL);
+  }
+}
+
+TextLayer *text_layer_create(GRect frame) {
+  TextLayer *text_layer = heap_alloc_object(sizeof(TextLayer), s_watch_sizes.text_layer);
+  layer_init(&text_layer->layer, frame);
+  text_layer->layer.draw = text_layer_draw;
+  text_layer->font = font_find(FONT_KEY_GOTHIC_14);
+  text_layer->text_color = GColorBlack;
+  text_layer->background_color = GColorWhite;
+  text_layer->overflow_mode = GTextOverflowModeTrailingEllipsis;
+  return text_layer;
+}
+
+void text_layer_destroy(TextLayer *text_layer) {
+  layer_deinit(&text_layer->layer);
+  sim_free(text_layer);
+}
+
+void text_layer_set_text(TextLayer *text_layer, const char *text) {
+  text_layer->text = text;
+}
+
+void text_layer_set_background_color(TextLayer *text_layer, GColor color) {
+  text_layer->background_color = color;
+}
+
+void text_layer_set_text_color(TextLayer *text_layer, GColor color) {
+  text_layer->text_color = color;
+}
+
+void text_layer_set_font(TextLayer *text_layer, GFont font) {
+  text_layer->font = font;
+}
+
+void text_layer_set_text_alignment(TextLayer *text_layer, GTextAlignment text_alignment) {
+  text_layer->alignment = text_alignment;
+}
+
+void text_layer_set_overflow_mode(TextLayer *text_layer, GTextOverflowMode line_mode) {
+  text_layer->overflow_mode = line_mode;
+}
+
+struct BitmapLayer {
+  Layer layer;
+  const GBitmap *bitmap;
+  GAlign alignment;
+  GColor background_color;
+  GCompOp compositing_mode;
+};
+
+static void bitmap_layer_draw(Layer *layer, GContext *ctx) {
+  BitmapLayer *bitmap_layer = (BitmapLayer *)layer;
+  graphics_context_set_fill_color(ctx, bitmap_layer->background_color);
+  graphics_fill_rect(ctx, layer->bounds, 0, GCornerNone);
+  if (bitmap_layer->bitmap != NULL) {
+    draw_record((DrawRecord){ .bitmap = bitmap_layer->bitmap });
+  }
+}
+
+BitmapLayer *bitmap_layer_create(GRect frame) {
+  BitmapLayer *bitmap_layer = heap_alloc_object(sizeof(BitmapLayer), s_watch_sizes.bitmap_layer);
+  layer_init(&bitmap_layer->layer, frame);
+  bitmap_layer->layer.draw = bitmap_layer_draw;
+  bitmap_layer->background_color = GColorClear;
+  return bitmap_layer;
+}
+
+void bitmap_layer_destroy(BitmapLayer *bitmap_layer) {
+  layer_deinit(&bitmap_layer->layer);
+  sim_free(bitmap_layer);
+}
+
+void bitmap_layer_set_bitmap(BitmapLayer *bitmap_layer, const GBitmap *bitmap) {
+  bitmap_layer->bitmap = bitmap;
+}
+
+void bitmap_layer_set_alignment(BitmapLayer *bitmap_layer, GAlign alignment) {
+  bitmap_layer->alignment = alignment;
+}
+
+void bitmap_layer_set_background_color(BitmapLayer *bitmap_layer, GColor color) {
+  bitmap_layer->background_color = color;
+}
+
+void bitmap_layer_set_compositing_mode(BitmapLayer *bitmap_layer, GCompOp mode) {
+  bitmap_layer->compositing_mode = mode;
+}
+
+// menus
+
+struct MenuLayer {
+  Layer layer;
+  MenuLayerCallbacks callbacks;
+  void *callback_context;
+  MenuIndex selected;
+};
+
+static uint16_t menu_num_sections(MenuLayer *menu_layer) {
+  return menu_layer->callbacks.get_num_sections != NULL
+    ? menu_layer->callbacks.get_num_sections(menu_layer, menu_layer->callback_context)
+    : 1;
+}
+
+static uint16_t menu_num_rows(MenuLayer *menu_layer, uint16_t section) {
+  return menu_layer->callbacks.get_num_rows(menu_layer, section, menu_layer->callback_context);
+}
+
+static int16_t menu_header_height(MenuLayer *menu_layer, uint16_t section) {
+  return menu_layer->callbacks.get_header_height != NULL
+    ? menu_layer->callbacks.get_header_height(menu_layer, section, menu_layer->callback_context)
+    : 0;
+}
+
+static int16_t menu_cell_height(MenuLayer *menu_layer, MenuIndex *index) {
+  return menu_layer->callbacks.get_cell_height != NULL
+    ? menu_layer->callbacks.get_cell_height(menu_layer, index, menu_layer->callback_context)
+    : 44;
+}
+
+// scrolls so the selected row is on screen, and draws the headers and rows that are
+static void menu_layer_draw(Layer *layer, GContext *ctx) {
+  MenuLayer *menu_layer = (MenuLayer *)layer;
+  const uint16_t num_sections = menu_num_sections(menu_layer);
+
+  int scroll = 0;
+  int y = 0;
+  for (uint16_t section = 0; section < num_sections; section++) {
+    y += menu_header_height(menu_layer, section);
+    for (uint16_t row = 0; row < menu_num_rows(menu_layer, section); row++) {
+      MenuIndex index = { section, row };
+      const int16_t height = menu_cell_height(menu_layer, &index);
+      if (section == menu_layer->selected.section && row == menu_layer->selected.row && y + height > layer->bounds.size.h) {
+        scroll = y + height - layer->bounds.size.h;
+      }
+      y += height;
+    }
+  }
+
+  y = -scroll;
+  for (uint16_t section = 0; section < num_sections && y < layer->bounds.size.h; section++) {
+    const int16_t header_height = menu_header_height(menu_layer, section);
+    if (header_height > 0 && y + header_height > 0 && menu_layer->callbacks.draw_header != NULL) {
+      Layer cell_layer = { .bounds = GRect(0, 0, layer->bounds.size.w, header_height) };
+      menu_layer->callbacks.draw_header(ctx, &cell_layer, section, menu_layer->callback_context);
+    }
+    y += header_height;
+
+    for (uint16_t row = 0; row < menu_num_rows(menu_layer, section) && y < layer->bounds.size.h; row++) {
+      MenuIndex index = { section, row };
+      const int16_t height = menu_cell_height(menu_layer, &index);
+      if (y + height > 0) {
+        Layer cell_layer = { .bounds = GRect(0, 0, layer->bounds.size.w, height) };
+        menu_layer->callbacks.draw_row(ctx, &cell_layer, &index, menu_layer->callback_context);
+      }
+      y += height;
+    }
+  }
+}
+
+MenuLayer *menu_layer_create(GRect frame) {
+  MenuLayer *menu_layer = heap_alloc_object(sizeof(MenuLayer), s_watch_sizes.menu_layer);
+  layer_init(&menu_layer->layer, frame);
+  menu_layer->layer.draw = menu_layer_draw;
+  return menu_layer;
+}
+
+void menu_layer_destroy(MenuLayer *menu_layer) {
+  layer_deinit(&menu_layer->layer);
+  sim_free(menu_layer);
+}
+
+Layer *menu_layer_get_layer(const MenuLayer *menu_layer) {
+  return (Layer *)&menu_layer->layer;
+}
+
+void menu_layer_set_callbacks(MenuLayer *menu_layer, void *callback_context, MenuLayerCallbacks callbacks) {
+  menu_layer->callbacks = callbacks;
+  menu_layer->callback_context = callback_context;
+}
+
+void menu_layer_set_normal_colors(MenuLayer *menu_layer, GColor background, GColor foreground) {
+}
+
+void menu_layer_set_highlight_colors(MenuLayer *menu_layer, GColor background, GColor foreground) {
+}
+
+bool menu_layer_is_index_selected(const MenuLayer *menu_layer, MenuIndex *index) {
+  return menu_layer->selected.section == index->section && menu_layer->selected.row == index->row;
+}
+
+void menu_cell_basic_draw(GContext *ctx, const Layer *cell_layer, const char *title, const char *subtitle, GBitmap *icon) {
+  graphics_draw_text(ctx, title, font_find(FONT_KEY_GOTHIC_24), cell_layer->bounds,
+    GTextOverflowModeTrailingEllipsis, GTextAlignmentLeft, NULL);
+  if (subtitle != NULL) {
+    graphics_draw_text(ctx, subtitle, font_find(FONT_KEY_GOTHIC_18), cell_layer->bounds,
+      GTextOverflowModeTrailingEllipsis, GTextAlignmentLeft, NULL);
+  }
+}
+
+// windows and clicks
+
+struct Window {
+  Layer root_layer;
+  HeapOwner *owner;
+  WindowHandlers handlers;
+  ClickConfigProvider click_config_provider;
+  void *click_context;
+  ClickHandler click_handlers[NUM_BUTTONS];
+  MenuLayer *menu_layer;
+  GColor background_color;
+  bool is_loaded;
+};
+
+static Window *s_stack[8];
+static size_t s_stack_count;
+static Window *s_configuring_window;
+
+Window *sim_window_create(const char *file) {
+  // everything the window's code allocates from here on is charged to it
+  s_owner = heap_owner_create(file);
+
+  Window *window = heap_alloc_object(sizeof(Window), s_watch_sizes.window);
+  layer_init(&window->root_layer, GRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT));
+  window->owner = s_owner;
+  window->background_color = GColorWhite;
+  return window;
+}
+
+void window_destroy(Window *window) {
+  layer_deinit(&window->root_layer);
+  sim_free(window);
+}
+
+Layer *window_get_root_layer(const Window *window) {
+  return (Layer *)&window->root_layer;
+}
+
+void window_set_background_color(Window *window, GColor background_color) {
+  window->background_color = background_color;
+}
+
+void window_set_window_handlers(Window *window, WindowHandlers handlers) {
+  window->handlers = handlers;
+}
+
+void window_set_click_config_provider(Window *window, ClickConfigProvider click_config_provider) {
+  window->click_config_provider = click_config_provider;
+  window->click_context = window;
+}
+
+void window_single_click_subscribe(ButtonId button_id, ClickHandler handler) {
+  s_configuring_window->click_handlers[button_id] = handler;
+}
+
+void window_single_repeating_click_subscribe(ButtonId button_id, uint16_t repeat_interval_ms, ClickHandler handler) {
+  s_configuring_window->click_handlers[button_id] = handler;
+}
+
+ButtonId click_recognizer_get_button_id(ClickRecognizerRef recognizer) {
+  return *(ButtonId *)recognizer;
+}
+
+void menu_layer_set_click_config_onto_window(MenuLayer *menu_layer, struct Window *window) {
+  window->menu_layer = menu_layer;
+}
+
+static void window_call(Window *window, const char *event, WindowHandler handler) {
+  if (handler != NULL) {
+    DISPATCH(window->owner, event, handler(window));
+  }
+}
+
+static void window_configure_clicks(Window *window) {
+  memset(window->click_handlers, 0, sizeof(window->click_handlers));
+  if (window->click_config_provider != NULL) {
+    s_configuring_window = window;
+    DISPATCH(window->owner, "click_config", window->click_config_provider(window->click_context));
+    s_configuring_window = NULL;
+  }
+}
+
+static void window_become_top(Window *window) {
+  window_configure_clicks(window);
+  window_call(window, "appear", window->handlers.appear);
+}
+
+static void window_unload(Window *window) {
+  const HeapOwner *owner = window->owner;
+  printf("[heap] %s unload: current %zu peak %zu\n", owner->name, owner->current, owner->peak);
+
+  window->is_loaded = false;
+  // the handler usually destroys the window, so it isn't touched afterwards
+  window_call(window, "unload", window->handlers.unload);
+}
+
+void window_stack_push(Window *window, bool animated) {
+  Window *previous = s_stack_count > 0 ? s_stack[s_stack_count - 1] : NULL;
+  s_stack[s_stack_count++] = window;
+
+  if (!window->is_loaded) {
+    window->is_loaded = true;
+    window_call(window, "load", window->handlers.load);
+  }
+  if (previous != NULL) {
+    window_call(previous, "disappear", previous->handlers.disappear);
+  }
+  window_become_top(window);
+}
+
+bool window_stack_remove(Window *window, bool animated) {
+  size_t index = 0;
+  while (index < s_stack_count && s_stack[index] != window) {
+    index++;
+  }
+  if (index == s_stack_count) {
+    return false;
+  }
+
+  const bool was_top = index == s_stack_count - 1;
+  memmove(&s_stack[index], &s_stack[index + 1], (s_stack_count - index - 1) * sizeof(Window *));
+  s_stack_count--;
+
+  if (was_top) {
+    window_call(window, "disappear", window->handlers.disappear);
+  }
+  window_unload(window);
+  if (was_top && s_stack_count > 0) {
+    window_become_top(s_stack[s_stack_count - 1]);
+  }
+  return true;
+}
+
+Window *window_stack_pop(bool animated) {
+  if (s_stack_count == 0) {
+    return NULL;
+  }
+
+  Window *window = s_stack[s_stack_count - 1];
+  window_stack_remove(window, animated);
+  return window;
+}
+
+void window_stack_pop_all(const bool animated) {
+  if (s_stack_count > 0) {
+    Window *top = s_stack[s_stack_count - 1];
+    window_call(top, "disappear", top->handlers.disappear);
+  }
+  while (s_stack_count > 0) {
+    window_unload(s_stack[--s_stack_count]);
+  }
+}
+
+static const char *const s_button_events[NUM_BUTTONS] = {
+  "click(BACK)", "click(UP)", "click(SELECT)", "click(DOWN)",
+};
+
+// moves the selection one row, skipping empty sections; false at either end
+static bool menu_layer_move_selection(MenuLayer *menu_layer, bool down) {
+  const uint16_t num_sections = menu_num_sections(menu_layer);
+  MenuIndex index = menu_layer->selected;
+  do {
+    if (down) {
+      if (index.row + 1 < menu_num_rows(menu_layer, index.section)) {
+        index.row++;
+      } else if (index.section + 1 < num_sections) {
+        index = (MenuIndex){ index.section + 1, 0 };
+        if (menu_num_rows(menu_layer, index.section) == 0) {
+          continue;
+        }
+      } else {
+        return false;
+      }
+    } else {
+      if (index.row > 0) {
+        index.row--;
+      } else if (index.section > 0) {
+        index.section--;
+        const uint16_t num_rows = menu_num_rows(menu_layer, index.section);
+        if (num_rows == 0) {
+          continue;
+        }
+        index.row = num_rows - 1;
+      } else {
+        return false;
+      }
+    }
+    menu_layer->selected = index;
+    return true;
+  } while (true);
+}
+
+static void menu_layer_handle_click(MenuLayer *menu_layer, ButtonId button) {
+  switch (button) {
+    case BUTTON_ID_UP:
+    case BUTTON_ID_DOWN:
+      menu_layer_move_selection(menu_layer, button == BUTTON_ID_DOWN);
+      break;
+    case BUTTON_ID_SELECT:
+      if (menu_layer->callbacks.select_click != NULL) {
+        menu_layer->callbacks.select_click(menu_layer, &menu_layer->selected, menu_layer->callback_context);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+// simulation control
+
+void sim_press(ButtonId button) {
+  if (s_stack_count == 0) {
+    return;
+  }
+
+  Window *window = s_stack[s_stack_count - 1];
+  if (window->click_handlers[button] != NULL) {
+    DISPATCH(window->owner, s_button_events[button], window->click_handlers[button](&button, window->click_context));
+  } else if (window->menu_layer != NULL && button != BUTTON_ID_BACK) {
+    DISPATCH(window->owner, s_button_events[button], menu_layer_handle_click(window->menu_layer, button));
+  } else if (button == BUTTON_ID_BACK) {
+    // the system's back handler: pop the window, exiting the app if it was the last
+    window_stack_pop(true);
+  }
+}
+
+bool sim_is_running(void) {
+  return s_stack_count > 0;
+}
+
+size_t sim_window_count(void) {
+  return s_stack_count;
+}
+
+const char *sim_top_window_name(void) {
+  return s_stack_count > 0 ? s_stack[s_stack_count - 1]->owner->name : NULL;
+}
+
+void sim_advance(uint32_t ms) {
+  const uint64_t until = s_now_ms + ms;
+  while (s_timers != NULL && s_timers->fire_at <= until) {
+    AppTimer *timer = s_timers;
+    s_timers = timer->next;
+    s_now_ms = timer->fire_at;
+
+    HeapOwner *owner = s_stack_count > 0 ? s_stack[s_stack_count - 1]->owner : &s_app_owner;
+    DISPATCH(owner, "timer", timer->callback(timer->data));
+    free(timer);
+  }
+  s_now_ms = until;
+}
+
+static void render_layer(Layer *layer, GContext *ctx) {
+  if (layer->draw != NULL) {
+    layer->draw(layer, ctx);
+  }
+  if (layer->update_proc != NULL) {
+    layer->update_proc(layer, ctx);
+  }
+  for (Layer *child = layer->first_child; child != NULL; child = child->next_sibling) {
+    render_layer(child, ctx);
+  }
+}
+
+void sim_render(void) {
+  if (s_stack_count == 0) {
+    return;
+  }
+
+  Window *window = s_stack[s_stack_count - 1];
+  GContext ctx = { .fill_color = window->background_color };
+  s_draws_count = 0;
+  DISPATCH(window->owner, "render", render_layer(&window->root_layer, &ctx));
+}
+
+bool sim_frame_has_text(const char *text) {
+  for (size_t i = 0; i < s_draws_count; i++) {
+    if (s_draws[i].text != NULL && strcmp(s_draws[i].text, text) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t sim_frame_bitmap_count(void) {
+  size_t count = 0;
+  for (size_t i = 0; i < s_draws_count; i++) {
+    if (s_draws[i].bitmap != NULL) {
+      count++;
+    }
+  }
+  return count;
+}
+
+size_t sim_text_measure_count(void) {
+  return s_text_measure_count;
+}
+
+size_t sim_font_load_count(void) {
+  return s_font_load_count;
+}
+
+size_t sim_profile_count(void) {
+  return s_profiles_count;
+}
+
+const SimProfile *sim_profile_at(size_t index) {
+  return index < s_profiles_count ? &s_profiles[index] : NULL;
+}
+
+const SimProfile *sim_profile(const char *label) {
+  for (size_t i = 0; i < s_profiles_count; i++) {
+    if (strcmp(s_profiles[i].label, label) == 0) {
+      return &s_profiles[i];
+    }
+  }
+  return NULL;
+}
+
+void sim_profile_report(const char *flow) {
+  printf("[profile] %s %s: %-30s %5s %10s %10s %6s %7s\n", SIM_PLATFORM, flow, "handler", "calls", "cpu us", "max us", "allocs", "bytes");
+  for (size_t i = 0; i < s_profiles_count; i++) {
+    const SimProfile *profile = &s_profiles[i];
+    printf("[profile] %s %s: %-30s %5u %10.1f %10.1f %6zu %7zu\n", SIM_PLATFORM, flow, profile->label, profile->calls,
+      profile->cpu_ns / 1000.0, profile->max_cpu_ns / 1000.0, profile->allocs, profile->alloc_bytes);
+  }
+}
+
+void sim_reset(void) {
+  window_stack_pop_all(false);
+
+  while (s_timers != NULL) {
+    AppTimer *timer = s_timers;
+    s_timers = timer->next;
+    free(timer);
+  }
+  while (s_owners != NULL) {
+    HeapOwner *owner = s_owners;
+    s_owners = owner->next;
+    free(owner);
+  }
+
+  s_owner = &s_app_owner;
+  s_app_owner.current = s_app_owner.peak = 0;
+  s_heap_current = s_heap_peak = 0;
+  s_persist_count = 0;
+  s_now_ms = 0;
+  s_alloc_count = s_alloc_bytes = 0;
+  s_profiles_count = 0;
+  s_draws_count = 0;
+  s_text_measure_count = s_font_load_count = 0;
+}
+
+static int s_failures;
+
+void sim_check(bool condition, const char *file, int line, const char *fmt, ...) {
+  if (condition) {
+    return;
+  }
+
+  s_failures++;
+  printf("FAIL %s:%d [%s] ", file, line, SIM_PLATFORM);
+  va_list args;
+  va_start(args, fmt);
+  vprintf(fmt, args);
+  va_end(args);
+  printf("\n");
+}
+
+int sim_failures(void) {
+  return s_failures;
+}
@@ -0,0 +1,343 @@
+#pragma once
+// Host stand-in for the Pebble SDK header, covering the API this app uses.
+// The fake runtime behind it lives in pebble.c; tests drive it through sim.h.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// platforms, selected with -DPBL_PLATFORM_APLITE, _BASALT or _CHALK
+#define PBL_SDK_3 1
+#if PBL_PLATFORM_APLITE
+#define PBL_BW 1
+#define PBL_RECT 1
+#elif PBL_PLATFORM_BASALT
+#define PBL_COLOR 1
+#define PBL_RECT 1
+#elif PBL_PLATFORM_CHALK
+#define PBL_COLOR 1
+#define PBL_ROUND 1
+#else
+#error "define PBL_PLATFORM_APLITE, PBL_PLATFORM_BASALT or PBL_PLATFORM_CHALK"
+#endif
+
+#if PBL_COLOR
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_true)
+#else
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_false)
+#endif
+#if PBL_ROUND
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_true)
+#else
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_false)
+#endif
+
+#define ARRAY_LENGTH(array) (sizeof((array)) / sizeof((array)[0]))
+
+// every allocation the app makes is counted and charged to a window
+void *sim_malloc(size_t size);
+void *sim_calloc(size_t count, size_t size);
+void sim_free(void *ptr);
+#ifndef SIM_RUNTIME
+#define malloc(size) sim_malloc(size)
+#define calloc(count, size) sim_calloc(count, size)
+#define free(ptr) sim_free(ptr)
+#endif
+
+// logging
+typedef enum {
+  APP_LOG_LEVEL_ERROR = 1,
+  APP_LOG_LEVEL_WARNING = 50,
+  APP_LOG_LEVEL_INFO = 100,
+  APP_LOG_LEVEL_DEBUG = 200,
+  APP_LOG_LEVEL_DEBUG_VERBOSE = 255,
+} AppLogLevel;
+
+void app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...);
+#define APP_LOG(level, fmt, ...) app_log(level, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
+
+// geometry
+typedef struct {
+  int16_t x;
+  int16_t y;
+} GPoint;
+
+typedef struct {
+  int16_t w;
+  int16_t h;
+} GSize;
+
+typedef struct {
+  GPoint origin;
+  GSize size;
+} GRect;
+
+#define GPoint(x, y) ((GPoint){ (x), (y) })
+#define GSize(w, h) ((GSize){ (w), (h) })
+#define GRect(x, y, w, h) ((GRect){ { (x), (y) }, { (w), (h) } })
+
+GRect grect_crop(GRect rect, int32_t crop_size_px);
+
+// colors
+typedef union {
+  uint8_t argb;
+} GColor8;
+typedef GColor8 GColor;
+
+#define GColorClearARGB8 ((uint8_t)0b00000000)
+#define GColorBlackARGB8 ((uint8_t)0b11000000)
+#define GColorWhiteARGB8 ((uint8_t)0b11111111)
+#define GColorWindsorTanARGB8 ((uint8_t)0b11100100)
+#define GColorChromeYellowARGB8 ((uint8_t)0b11111000)
+
+#define GColorClear ((GColor8){ .argb = GColorClearARGB8 })
+#define GColorBlack ((GColor8){ .argb = GColorBlackARGB8 })
+#define GColorWhite ((GColor8){ .argb = GColorWhiteARGB8 })
+#define GColorWindsorTan ((GColor8){ .argb = GColorWindsorTanARGB8 })
+#define GColorChromeYellow ((GColor8){ .argb = GColorChromeYellowARGB8 })
+
+// status codes
+typedef enum {
+  S_SUCCESS = 0,
+  E_ERROR = -1,
+  E_DOES_NOT_EXIST = -4,
+} StatusCode;
+
+// time
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms);
+
+// persist
+bool persist_exists(const uint32_t key);
+int persist_read_string(const uint32_t key, char *buffer, const size_t buffer_size);
+int persist_write_string(const uint32_t key, const char *cstring);
+
+// app timers
+typedef struct AppTimer AppTimer;
+typedef void (*AppTimerCallback)(void *data);
+
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data);
+void app_timer_cancel(AppTimer *timer_handle);
+void app_event_loop(void);
+
+// resources and bitmaps
+typedef enum {
+  RESOURCE_ID_IMAGE_UP_ARROW = 1,
+  RESOURCE_ID_IMAGE_DOWN_ARROW,
+  RESOURCE_ID_IMAGE_APP_ICON,
+  RESOURCE_ID_IMAGE_JAVAPAY,
+} ResourceId;
+
+typedef enum {
+  GBitmapFormat1Bit = 0,
+  GBitmapFormat8Bit,
+  GBitmapFormat1BitPalette,
+  GBitmapFormat2BitPalette,
+  GBitmapFormat4BitPalette,
+} GBitmapFormat;
+
+typedef struct GBitmap GBitmap;
+
+GBitmap *gbitmap_create_with_resource(uint32_t resource_id);
+GBitmap *gbitmap_create_blank(GSize size, GBitmapFormat format);
+GBitmap *gbitmap_create_blank_with_palette(GSize size, GBitmapFormat format, GColor *palette, bool free_on_destroy);
+uint16_t gbitmap_get_bytes_per_row(const GBitmap *bitmap);
+uint8_t *gbitmap_get_data(const GBitmap *bitmap);
+GBitmapFormat gbitmap_get_format(const GBitmap *bitmap);
+GColor *gbitmap_get_palette(const GBitmap *bitmap);
+GRect gbitmap_get_bounds(const GBitmap *bitmap);
+void gbitmap_destroy(GBitmap *bitmap);
+
+// fonts and text
+typedef struct FontInfo FontInfo;
+typedef FontInfo *GFont;
+
+#define FONT_KEY_GOTHIC_14 "RESOURCE_ID_GOTHIC_14"
+#define FONT_KEY_GOTHIC_14_BOLD "RESOURCE_ID_GOTHIC_14_BOLD"
+#define FONT_KEY_GOTHIC_18 "RESOURCE_ID_GOTHIC_18"
+#define FONT_KEY_GOTHIC_18_BOLD "RESOURCE_ID_GOTHIC_18_BOLD"
+#define FONT_KEY_GOTHIC_24 "RESOURCE_ID_GOTHIC_24"
+#define FONT_KEY_GOTHIC_28 "RESOURCE_ID_GOTHIC_28"
+
+typedef enum {
+  GTextOverflowModeWordWrap,
+  GTextOverflowModeTrailingEllipsis,
+  GTextOverflowModeFill,
+} GTextOverflowMode;
+
+typedef enum {
+  GTextAlignmentLeft,
+  GTextAlignmentCenter,
+  GTextAlignmentRight,
+} GTextAlignment;
+
+typedef struct GTextAttributes GTextAttributes;
+
+GFont fonts_get_system_font(const char *font_key);
+
+// graphics
+typedef struct GContext GContext;
+
+typedef enum {
+  GCornerNone = 0,
+  GCornersAll = 0xf,
+} GCornerMask;
+
+typedef enum {
+  GCompOpAssign,
+  GCompOpAssignInverted,
+  GCompOpOr,
+  GCompOpAnd,
+  GCompOpClear,
+  GCompOpSet,
+} GCompOp;
+
+typedef enum {
+  GAlignCenter,
+  GAlignTopLeft,
+  GAlignTopRight,
+  GAlignTop,
+  GAlignLeft,
+  GAlignBottom,
+  GAlignRight,
+  GAlignBottomRight,
+  GAlignBottomLeft,
+} GAlign;
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color);
+void graphics_context_set_fill_color(GContext *ctx, GColor color);
+void graphics_context_set_text_color(GContext *ctx, GColor color);
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1);
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask);
+void graphics_draw_text(GContext *ctx, const char *text, GFont const font, const GRect box, const GTextOverflowMode overflow_mode, const GTextAlignment alignment, GTextAttributes *text_attributes);
+GSize graphics_text_layout_get_content_size(const char *text, GFont const font, const GRect box, const GTextOverflowMode overflow_mode, const GTextAlignment alignment);
+
+// layers
+typedef struct Layer Layer;
+typedef void (*LayerUpdateProc)(struct Layer *layer, GContext *ctx);
+
+Layer *layer_create(GRect frame);
+void layer_destroy(Layer *layer);
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc);
+void layer_mark_dirty(Layer *layer);
+void layer_set_frame(Layer *layer, GRect frame);
+GRect layer_get_frame(const Layer *layer);
+GRect layer_get_bounds(const Layer *layer);
+void layer_add_child(Layer *parent, Layer *child);
+
+typedef struct TextLayer TextLayer;
+
+TextLayer *text_layer_create(GRect frame);
+void text_layer_destroy(TextLayer *text_layer);
+void text_layer_set_text(TextLayer *text_layer, const char *text);
+void text_layer_set_background_color(TextLayer *text_layer, GColor color);
+void text_layer_set_text_color(TextLayer *text_layer, GColor color);
+void text_layer_set_font(TextLayer *text_layer, GFont font);
+void text_layer_set_text_alignment(TextLayer *text_layer, GTextAlignment text_alignment);
+void text_layer_set_overflow_mode(TextLayer *text_layer, GTextOverflowMode line_mode);
+
+typedef struct BitmapLayer BitmapLayer;
+
+BitmapLayer *bitmap_layer_create(GRect frame);
+void bitmap_layer_destroy(BitmapLayer *bitmap_layer);
+void bitmap_layer_set_bitmap(BitmapLayer *bitmap_layer, const GBitmap *bitmap);
+void bitmap_layer_set_alignment(BitmapLayer *bitmap_layer, GAlign alignment);
+void bitmap_layer_set_background_color(BitmapLayer *bitmap_layer, GColor color);
+void bitmap_layer_set_compositing_mode(BitmapLayer *bitmap_layer, GCompOp mode);
+
+// windows and clicks
+typedef struct Window Window;
+typedef void (*WindowHandler)(struct Window *window);
+
+typedef struct {
+  WindowHandler load;
+  WindowHandler appear;
+  WindowHandler disappear;
+  WindowHandler unload;
+} WindowHandlers;
+
+typedef enum {
+  BUTTON_ID_BACK = 0,
+  BUTTON_ID_UP,
+  BUTTON_ID_SELECT,
+  BUTTON_ID_DOWN,
+  NUM_BUTTONS,
+} ButtonId;
+
+typedef void *ClickRecognizerRef;
+typedef void (*ClickHandler)(ClickRecognizerRef recognizer, void *context);
+typedef void (*ClickConfigProvider)(void *context);
+
+// windows are named after the file that creates them, for the heap and profile reports
+#define window_create() sim_window_create(__FILE__)
+Window *sim_window_create(const char *file);
+void window_destroy(Window *window);
+Layer *window_get_root_layer(const Window *window);
+void window_set_background_color(Window *window, GColor background_color);
+void window_set_window_handlers(Window *window, WindowHandlers handlers);
+void window_set_click_config_provider(Window *window, ClickConfigProvider click_config_provider);
+void window_stack_push(Window *window, bool animated);
+bool window_stack_remove(Window *window, bool animated);
+Window *window_stack_pop(bool animated);
+void window_stack_pop_all(const bool animated);
+
+void window_single_click_subscribe(ButtonId button_id, ClickHandler handler);
+void window_single_repeating_click_subscribe(ButtonId button_id, uint16_t repeat_interval_ms, ClickHandler handler);
+ButtonId click_recognizer_get_button_id(ClickRecognizerRef recognizer);
+
+// menus
+typedef struct MenuLayer MenuLayer;
+
+typedef struct {
+  uint16_t section;
+  uint16_t row;
+} MenuIndex;
+
+typedef uint16_t (*MenuLayerGetNumberOfSectionsCallback)(struct MenuLayer *menu_layer, void *callback_context);
+typedef uint16_t (*MenuLayerGetNumberOfRowsInSectionsCallback)(struct MenuLayer *menu_layer, uint16_t section_index, void *callback_context);
+typedef int16_t (*MenuLayerGetCellHeightCallback)(struct MenuLayer *menu_layer, MenuIndex *cell_index, void *callback_context);
+typedef int16_t (*MenuLayerGetHeaderHeightCallback)(struct MenuLayer *menu_layer, uint16_t section_index, void *callback_context);
+typedef void (*MenuLayerDrawRowCallback)(GContext *ctx, const Layer *cell_layer, MenuIndex *cell_index, void *callback_context);
+typedef void (*MenuLayerDrawHeaderCallback)(GContext *ctx, const Layer *cell_layer, uint16_t section_index, void *callback_context);
+typedef void (*MenuLayerSelectCallback)(struct MenuLayer *menu_layer, MenuIndex *cell_index, void *callback_context);
+
+typedef struct {
+  MenuLayerGetNumberOfSectionsCallback get_num_sections;
+  MenuLayerGetNumberOfRowsInSectionsCallback get_num_rows;
+  MenuLayerGetCellHeightCallback get_cell_height;
+  MenuLayerGetHeaderHeightCallback get_header_height;
+  MenuLayerDrawRowCallback draw_row;
+  MenuLayerDrawHeaderCallback draw_header;
+  MenuLayerSelectCallback select_click;
+} MenuLayerCallbacks;
+
+#define MENU_CELL_BASIC_HEADER_HEIGHT ((const int16_t)16)
+#define MENU_CELL_ROUND_FOCUSED_SHORT_CELL_HEIGHT ((const int16_t)68)
+#define MENU_CELL_ROUND_UNFOCUSED_SHORT_CELL_HEIGHT ((const int16_t)24)
+
+MenuLayer *menu_layer_create(GRect frame);
+void menu_layer_destroy(MenuLayer *menu_layer);
+Layer *menu_layer_get_layer(const MenuLayer *menu_layer);
+void menu_layer_set_callbacks(MenuLayer *menu_layer, void *callback_context, MenuLayerCallbacks callbacks);
+void menu_layer_set_click_config_onto_window(MenuLayer *menu_layer, struct Window *window);
+void menu_layer_set_normal_colors(MenuLayer *menu_layer, GColor background, GColor foreground);
+void menu_layer_set_highlight_colors(MenuLayer *menu_layer, GColor background, GColor foreground);
+bool menu_layer_is_index_selected(const MenuLayer *menu_layer, MenuIndex *index);
+void menu_cell_basic_draw(GContext *ctx, const Layer *cell_layer, const char *title, const char *subtitle, GBitmap *icon);
+
+typedef void (*SimpleMenuLayerSelectCallback)(int index, void *context);
+
+typedef struct {
+  const char *title;
+  const char *subtitle;
+  GBitmap *icon;
+  SimpleMenuLayerSelectCallback callback;
+} SimpleMenuItem;
+
+typedef struct {
+  const char *title;
+  const SimpleMenuItem *items;
+  uint32_t num_items;
+} SimpleMenuSection;
@@ -0,0 +1,63 @@
+#pragma once
+#include <pebble.h>
+
+// Tests drive the fake runtime in pebble.c through these calls.
+
+// pops every window (running their unload handlers) and clears timers, persist, counters and profiles
+void sim_reset(void);
+// false once the window stack has emptied, i.e. the app would have exited
+bool sim_is_running(void);
+size_t sim_window_count(void);
+// name of the top window, such as "barcode_window", or NULL when the stack is empty
+const char *sim_top_window_name(void);
+
+// moves the clock forward, firing app timers as they come due
+void sim_advance(uint32_t ms);
+// draws the top window's layer tree, the way one frame would
+void sim_render(void);
+// presses a button on the top window: its click handler, else its menu layer, else the system's back
+void sim_press(ButtonId button);
+
+// what the last sim_render drew
+bool sim_frame_has_text(const char *text);
+size_t sim_frame_bitmap_count(void);
+
+// calls the app has made to graphics_text_layout_get_content_size and fonts_get_system_font
+size_t sim_text_measure_count(void);
+size_t sim_font_load_count(void);
+
+// bytes the app has allocated and not freed, and the most it ever had at once
+size_t sim_heap_current(void);
+size_t sim_heap_peak(void);
+
+// what one handler, such as "card_window.click(UP)" or "barcode_window.appear", cost
+// across its calls; work done by handlers it caused to run is counted under theirs
+typedef struct {
+  char label[48];
+  unsigned calls;
+  uint64_t cpu_ns;
+  uint64_t max_cpu_ns;
+  size_t allocs;
+  size_t alloc_bytes;
+} SimProfile;
+
+// NULL if the handler hasn't run since sim_reset
+const SimProfile *sim_profile(const char *label);
+size_t sim_profile_count(void);
+const SimProfile *sim_profile_at(size_t index);
+void sim_profile_report(const char *flow);
+
+// records a failure without stopping the test; sim_failures() is the test's exit status
+#define SIM_CHECK(condition, ...) sim_check((condition), __FILE__, __LINE__, __VA_ARGS__)
+void sim_check(bool condition, const char *file, int line, const char *fmt, ...);
+int sim_failures(void);
+
+#if PBL_PLATFORM_APLITE
+#define SIM_PLATFORM "aplite"
+#elif PBL_PLATFORM_BASALT && PDF417_PALETTIZED
+#define SIM_PLATFORM "basalt-palettized"
+#elif PBL_PLATFORM_BASALT
+#define SIM_PLATFORM "basalt"
+#else
+#define SIM_PLATFORM "chalk"
+#endif
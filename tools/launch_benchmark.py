@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+#
+# Measures the time from app launch to the first frame with a barcode on it,
+# on the Pebble emulator for every platform in appinfo.json.
+#
+# The app is built with BENCHMARK_LAUNCH, which seeds STORAGE_CARD_NUMBER and
+# logs launch_to_barcode_ms from main() to the first draw of the barcode. That
+# build goes to build_benchmark/ and is installed from there, so the normal
+# build/ is left alone and never carries the seeded card number.
+#
+# Usage: tools/launch_benchmark.py [--runs N] [--warmup N] [--platform NAME]
+#
+
+import argparse
+import glob
+import json
+import os
+import re
+import selectors
+import statistics
+import subprocess
+import sys
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+MARKER = re.compile(r'launch_to_barcode_ms=(\d+)')
+
+
+def build():
+    env = dict(os.environ, BENCHMARK_LAUNCH='1')
+    subprocess.check_call(['pebble', 'build'], cwd=ROOT, env=env)
+    pbws = glob.glob(os.path.join(ROOT, 'build_benchmark', '*.pbw'))
+    if len(pbws) != 1:
+        raise RuntimeError('expected one .pbw in build_benchmark/, found {}'.format(len(pbws)))
+    return pbws[0]
+
+
+def run_once(pbw, platform, timeout):
+    # installing relaunches the app, so every run is a cold launch
+    process = subprocess.Popen(
+        ['pebble', 'install', '--emulator', platform, '--logs', pbw],
+        cwd=ROOT, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    # read the pipe's fd directly: a buffered readline() can pull the marker
+    # line into its buffer, where select() no longer sees it
+    fd = process.stdout.fileno()
+    selector = selectors.DefaultSelector()
+    selector.register(fd, selectors.EVENT_READ)
+    deadline = time.time() + timeout
+    pending = b''
+    try:
+        while selector.select(max(0, deadline - time.time())):
+            chunk = os.read(fd, 4096)
+            if not chunk:
+                break
+            lines = (pending + chunk).split(b'\n')
+            pending = lines.pop()
+            for line in lines:
+                match = MARKER.search(line.decode('utf-8', 'replace'))
+                if match:
+                    return int(match.group(1))
+    finally:
+        selector.close()
+        process.kill()
+        process.wait()
+    raise RuntimeError('no barcode frame on {} within {}s'.format(platform, timeout))
+
+
+def percentile(samples, p):
+    ordered = sorted(samples)
+    rank = max(1, -(-len(ordered) * p // 100))
+    return ordered[int(rank) - 1]
+
+
+def main():
+    with open(os.path.join(ROOT, 'appinfo.json')) as f:
+        platforms = json.load(f)['targetPlatforms']
+
+    parser = argparse.ArgumentParser(description='Launch-to-barcode latency on the Pebble emulator.')
+    parser.add_argument('--runs', type=int, default=20)
+    parser.add_argument('--warmup', type=int, default=1)
+    parser.add_argument('--timeout', type=float, default=60)
+    parser.add_argument('--platform', action='append', choices=platforms)
+    args = parser.parse_args()
+
+    pbw = build()
+
+    results = {}
+    for platform in args.platform or platforms:
+        for _ in range(args.warmup):
+            run_once(pbw, platform, args.timeout)
+        samples = [run_once(pbw, platform, args.timeout) for _ in range(args.runs)]
+        results[platform] = samples
+        print('{}: {}'.format(platform, ' '.join(str(s) for s in samples)), file=sys.stderr)
+
+    print('{:<10}{:>6}{:>10}{:>10}'.format('platform', 'runs', 'median', 'p95'))
+    for platform, samples in results.items():
+        print('{:<10}{:>6}{:>8.0f}ms{:>8d}ms'.format(
+            platform, len(samples), statistics.median(samples), percentile(samples, 95)))
+
+    subprocess.call(['pebble', 'kill'], cwd=ROOT)
+
+
+if __name__ == '__main__':
+    main()